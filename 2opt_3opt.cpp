@@ -155,20 +155,40 @@ pair<double, long long> run3Opt(vector<int> &route, const vector<pair<double,dou
     return make_pair(dist, elapsed_ms);
 }
 
-// ------------------- main -------------------
-int main(int argc, char* argv[]){
-    ios::sync_with_stdio(false);
-    cin.tie(nullptr);
+// ------------------- Решение одного файла -------------------
+
+// Итог по одному входному файлу — одна строка results_2opt_3opt.csv
+struct RunResult {
+    string name;
+    double dist2Opt = 0.0;
+    long long time2Opt = 0;
+    double dist3Opt = 0.0;
+    long long time3Opt = 0;
+};
 
-    // Считываем количество вершин
-    int N;
-    cin >> N;
-    vector<pair<double,double>> coords(N);
+// Какие методы запускать: "both" (2-opt, затем 3-opt) или только "2opt".
+// 3-opt всегда стартует с маршрута после 2-opt.
+bool runs3Opt(const string &mode){ return mode == "both"; }
+
+// Считывает количество вершин и их координаты.
+// Возвращает false, если N не положительно или вход оборвался.
+bool readCoords(istream &in, vector<pair<double,double>> &coords){
+    int N = 0;
+    if(!(in >> N) || N <= 0) return false;
+    coords.resize(N);
     for(int i = 0; i < N; i++){
         double x, y;
-        cin >> x >> y;
+        if(!(in >> x >> y)) return false;
         coords[i] = {x, y};
     }
+    return true;
+}
+
+// Прогоняет методы согласно mode, сохраняет маршрут в result_2opt_3opt/<routeName>.
+// Возвращает false при ошибке записи маршрута.
+bool solveCoords(const vector<pair<double,double>> &coords, const string &name,
+                 const string &routeName, const string &mode, RunResult &out){
+    int N = (int)coords.size();
 
     // Начальный маршрут: 0..N-1
     vector<int> route(N);
@@ -176,36 +196,18 @@ int main(int argc, char* argv[]){
 
     bool isCycle = true; // Если хотим тур (замкнутый), иначе false.
 
+    out.name = name;
+
     // 1) Отдельно прогоняем 2-opt (до локального минимума)
-    auto [dist2Opt, time2Opt] = run2Opt(route, coords, isCycle);
+    tie(out.dist2Opt, out.time2Opt) = run2Opt(route, coords, isCycle);
 
     // 2) После этого запускаем 3-opt (до локального минимума)
-    auto [dist3Opt, time3Opt] = run3Opt(route, coords, isCycle);
-
-    // Имя файла для CSV (если передали параметром)
-    string csvFilename = (argc > 1) ? argv[1] : "-";
-
-    // Выведем 1 строку CSV:
-    // csvFilename, dist_2opt, time_2opt(ms), dist_3opt, time_3opt(ms)
-    cout << csvFilename << ","
-         << fixed << setprecision(6) << dist2Opt << ","
-         << time2Opt << ","
-         << dist3Opt << ","
-         << time3Opt << "\n";
-
-    // Сохранение итогового маршрута в отдельный файл.
-    // Если передан второй параметр, используем его как имя файла, иначе "route.txt".
-    // Перед сохранением маршрута создаем папку result_2opt_3opt, если её нет.
-    if (!fs::exists("result_2opt_3opt")) {
-        if (!fs::create_directory("result_2opt_3opt")) {
-            cerr << "Ошибка при создании директории result_2opt_3opt." << endl;
-            return 1;
-        }
+    if(runs3Opt(mode)){
+        tie(out.dist3Opt, out.time3Opt) = run3Opt(route, coords, isCycle);
     }
 
-    // Если передан второй параметр, используем его как имя файла, иначе "route.txt"
-    // При этом путь дополняется префиксом "result_2opt_3opt/"
-    string routeFilename = (argc > 2) ? string("result_2opt_3opt/") + argv[2] : "result_2opt_3opt/route.txt";
+    // Путь дополняется префиксом "result_2opt_3opt/"
+    string routeFilename = "result_2opt_3opt/" + routeName;
     ofstream routeFile(routeFilename);
     if(routeFile.is_open()){
         for(int i = 0; i < N; i++){
@@ -215,7 +217,197 @@ int main(int argc, char* argv[]){
         routeFile.close();
     } else {
         cerr << "Ошибка при открытии файла для записи маршрута: " << routeFilename << endl;
+        return false;
+    }
+    return true;
+}
+
+// Строка CSV: filename, dist_2opt, time_2opt(ms), dist_3opt, time_3opt(ms)
+void writeCsvRow(ostream &out, const RunResult &r){
+    out << r.name << ","
+        << fixed << setprecision(6) << r.dist2Opt << ","
+        << r.time2Opt << ","
+        << r.dist3Opt << ","
+        << r.time3Opt << "\n";
+}
+
+// ------------------- Пакетный режим -------------------
+
+// Список входных файлов: все файлы каталога (по имени) либо строки манифеста.
+// В манифесте пустые строки и строки с '#' пропускаются, относительные пути
+// считаются от каталога манифеста.
+vector<string> listInputs(const string &source){
+    vector<string> files;
+    if(fs::is_directory(source)){
+        for(const auto &entry : fs::directory_iterator(source)){
+            if(entry.is_regular_file()){
+                files.push_back(entry.path().string());
+            }
+        }
+        sort(files.begin(), files.end());
+        return files;
+    }
+
+    ifstream manifest(source);
+    if(!manifest.is_open()){
+        cerr << "Не удалось открыть манифест: " << source << endl;
+        return files;
+    }
+    fs::path base = fs::path(source).parent_path();
+    string line;
+    while(getline(manifest, line)){
+        line.erase(0, line.find_first_not_of(" \t\r"));
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if(line.empty() || line[0] == '#') continue;
+        fs::path p(line);
+        files.push_back(p.is_relative() ? (base / p).string() : p.string());
+    }
+    return files;
+}
+
+// Имя файла маршрута, как в run_tests_2opt_3opt.bat: <файл>_route.txt
+string routeName(const string &file){
+    return fs::path(file).filename().string() + "_route.txt";
+}
+
+// Размер задачи — число вершин N из первой строки файла
+long long instanceSize(const string &file){
+    ifstream fin(file);
+    long long n = 0;
+    fin >> n;
+    return n;
+}
+
+// Решает все файлы на пуле из threadCount потоков, начиная с самых больших,
+// и пишет results_2opt_3opt.csv заново — строки в порядке inputs.
+// Время каждого метода меряется под нагрузкой от соседних потоков,
+// поэтому для замеров нужен threadCount = 1.
+int runBatch(const vector<string> &inputs, const string &mode, unsigned threadCount){
+    const size_t count = inputs.size();
+
+    // Два входа с одинаковым именем маршрута писали бы в один файл одновременно
+    map<string, size_t> owners;
+    for(size_t i = 0; i < count; i++){
+        auto [it, inserted] = owners.emplace(routeName(inputs[i]), i);
+        if(!inserted){
+            cerr << "Файлы " << inputs[it->second] << " и " << inputs[i]
+                 << " пишут в один result_2opt_3opt/" << it->first << endl;
+            return 1;
+        }
+    }
+
+    vector<long long> sizes(count);
+    for(size_t i = 0; i < count; i++){
+        sizes[i] = instanceSize(inputs[i]);
+    }
+    vector<size_t> order(count);
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&](size_t a, size_t b){
+        return sizes[a] > sizes[b];
+    });
+
+    vector<RunResult> results(count);
+    vector<char> solved(count, 0);
+    atomic<size_t> next{0};
+    mutex consoleMutex;
+
+    auto worker = [&](){
+        for(size_t k = next++; k < count; k = next++){
+            size_t idx = order[k];
+            ifstream fin(inputs[idx]);
+            vector<pair<double,double>> coords;
+            if(!fin.is_open() || !readCoords(fin, coords)){
+                lock_guard<mutex> lock(consoleMutex);
+                cerr << "Не удалось прочитать задачу из файла: " << inputs[idx] << endl;
+                continue;
+            }
+            string name = fs::path(inputs[idx]).filename().string();
+            solved[idx] = solveCoords(coords, name, routeName(inputs[idx]), mode, results[idx]);
+            lock_guard<mutex> lock(consoleMutex);
+            cerr << "Done " << inputs[idx] << endl;
+        }
+    };
+
+    threadCount = max(1u, min<unsigned>(threadCount, (unsigned)max<size_t>(count, 1)));
+    vector<thread> pool;
+    for(unsigned t = 0; t < threadCount; t++){
+        pool.emplace_back(worker);
+    }
+    for(auto &th : pool){
+        th.join();
+    }
+
+    ofstream fout("results_2opt_3opt.csv", ios::trunc);
+    fout << "filename,dist_2opt,time_2opt_ms,dist_3opt,time_3opt_ms\n";
+    int failed = 0;
+    for(size_t i = 0; i < count; i++){
+        if(solved[i]){
+            writeCsvRow(fout, results[i]);
+        } else {
+            failed++;
+        }
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+// ------------------- main -------------------
+int main(int argc, char* argv[]){
+    ios::sync_with_stdio(false);
+    cin.tie(nullptr);
+
+    // Необязательный первый параметр: --mode both|2opt (по умолчанию both)
+    string prog = argv[0];
+    string mode = "both";
+    if(argc > 2 && string(argv[1]) == "--mode"){
+        mode = argv[2];
+        if(mode != "both" && mode != "2opt"){
+            cerr << "Неизвестный режим: " << mode << " (ожидается both или 2opt)" << endl;
+            return 1;
+        }
+        argv += 2;
+        argc -= 2;
+    }
+
+    // Перед сохранением маршрутов создаем папку result_2opt_3opt, если её нет.
+    if (!fs::exists("result_2opt_3opt")) {
+        if (!fs::create_directory("result_2opt_3opt")) {
+            cerr << "Ошибка при создании директории result_2opt_3opt." << endl;
+            return 1;
+        }
+    }
+
+    // Пакетный режим: --batch <каталог|манифест> [число потоков]
+    if(argc > 1 && string(argv[1]) == "--batch"){
+        if(argc < 3){
+            cerr << "Usage: " << prog << " [--mode both|2opt] --batch <dir|manifest> [threads]\n";
+            return 1;
+        }
+        vector<string> inputs = listInputs(argv[2]);
+        if(inputs.empty()){
+            cerr << "Нет входных файлов: " << argv[2] << endl;
+            return 1;
+        }
+        unsigned threads = (argc > 3) ? (unsigned)max(1, atoi(argv[3]))
+                                      : max(1u, thread::hardware_concurrency());
+        return runBatch(inputs, mode, threads);
+    }
+
+    // Имя файла для CSV (если передали параметром)
+    string csvFilename = (argc > 1) ? argv[1] : "-";
+    // Если передан второй параметр, используем его как имя файла маршрута, иначе "route.txt"
+    string routeFilename = (argc > 2) ? argv[2] : "route.txt";
+
+    vector<pair<double,double>> coords;
+    if(!readCoords(cin, coords)){
+        cerr << "Не удалось прочитать задачу из stdin." << endl;
+        return 1;
     }
 
+    // Выведем 1 строку CSV
+    // (ошибка записи маршрута уже выведена в cerr, строку CSV всё равно печатаем)
+    RunResult res;
+    solveCoords(coords, csvFilename, routeFilename, mode, res);
+    writeCsvRow(cout, res);
+
     return 0;
 }
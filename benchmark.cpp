@@ -0,0 +1,521 @@
+#include <iostream>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <chrono>
+#include <map>
+#include <filesystem>
+#include <iomanip>
+#include <cmath>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+// Бенчмарк решателей (только Linux): генерирует задачи через gen_instances,
+// многократно запускает каждый режим 2_opt_3opt и knapsack_solvers на растущих N,
+// пишет медиану/p95 времени и пиковый RSS в CSV и сравнивает с базовым CSV.
+//
+//   benchmark [параметры]                 — прогон (см. printUsage)
+//   benchmark --compare <base.csv> <new.csv> — только сравнение двух прогонов
+
+namespace fs = std::filesystem;
+
+// --------------------------- Параметры --------------------------- //
+
+struct Options {
+    std::string binDir = ".";            // где лежат 2_opt_3opt, knapsack_solvers, gen_instances
+    std::string workDir = "bench_work";  // задачи и выходные файлы решателей
+    std::string out = "bench_results.csv";
+    std::string baseline;                // с чем сравнивать после прогона
+    std::string only;                    // "tsp" или "ks" — только одна задача
+    int repeats = 5;
+    double timeoutSec = 60.0;            // на один запуск; превышение обрывает кривую
+    long long memLimitMb = 4096;         // RLIMIT_AS для решателя
+    long long maxN = 1000000;
+    unsigned long long seed = 1;
+    double threshold = 0.10;             // допустимое относительное ухудшение
+    double minDeltaMs = 5.0;             // меньшие разницы времени считаем шумом
+};
+
+void printUsage(const char *prog) {
+    std::cerr << "Usage: " << prog << " [--bin-dir DIR] [--work-dir DIR] [--out FILE]\n"
+              << "       [--repeats R] [--timeout SEC] [--mem-limit MB] [--max-n N] [--seed S]\n"
+              << "       [--only tsp|ks] [--baseline FILE] [--threshold FRAC] [--min-delta-ms MS]\n"
+              << "       " << prog << " --compare <base.csv> <new.csv> [--threshold FRAC] [--min-delta-ms MS]\n";
+}
+
+// --------------------------- Запуск процесса --------------------------- //
+
+struct ProcResult {
+    bool ok = false;        // завершился с кодом 0
+    bool timedOut = false;
+    long long wallMs = 0;
+    long peakRssKb = 0;
+};
+
+// Запускает args[0] в каталоге cwd, stdin/stdout перенаправляются в файлы
+// (пустое имя — не перенаправлять stdin), stderr отбрасывается.
+// Пиковый RSS берётся из rusage самого процесса.
+ProcResult runProcess(const std::vector<std::string> &args, const std::string &cwd,
+                      const std::string &stdinFile, const std::string &stdoutFile,
+                      double timeoutSec, long long memLimitMb) {
+    ProcResult res;
+    auto start = std::chrono::steady_clock::now();
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        std::cerr << "fork() failed" << std::endl;
+        return res;
+    }
+    if (pid == 0) {
+        if (chdir(cwd.c_str()) != 0)
+            _exit(127);
+        if (!stdinFile.empty()) {
+            int in = open(stdinFile.c_str(), O_RDONLY);
+            if (in < 0 || dup2(in, 0) < 0)
+                _exit(127);
+        }
+        int out = open(stdoutFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        int err = open("/dev/null", O_WRONLY);
+        if (out < 0 || err < 0 || dup2(out, 1) < 0 || dup2(err, 2) < 0)
+            _exit(127);
+        if (memLimitMb > 0) {
+            rlimit rl;
+            rl.rlim_cur = rl.rlim_max = (rlim_t)memLimitMb * 1024 * 1024;
+            setrlimit(RLIMIT_AS, &rl);
+        }
+        std::vector<char*> argv;
+        for (const auto &a : args)
+            argv.push_back(const_cast<char*>(a.c_str()));
+        argv.push_back(nullptr);
+        execv(argv[0], argv.data());
+        _exit(127);
+    }
+
+    int status = 0;
+    rusage ru{};
+    while (true) {
+        pid_t r = wait4(pid, &status, WNOHANG, &ru);
+        if (r == pid)
+            break;
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (elapsed > timeoutSec) {
+            kill(pid, SIGKILL);
+            wait4(pid, &status, 0, &ru);
+            res.timedOut = true;
+            break;
+        }
+        usleep(2000);
+    }
+
+    res.wallMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                     std::chrono::steady_clock::now() - start).count();
+    res.peakRssKb = ru.ru_maxrss; // в Linux — килобайты
+    res.ok = !res.timedOut && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    return res;
+}
+
+// --------------------------- Задачи и режимы --------------------------- //
+
+// Режим решателя: какой бинарник, с каким --mode и какие числа брать из вывода
+struct Mode {
+    std::string problem;    // "tsp" или "ks"
+    std::string name;       // имя в CSV
+    std::string solverMode; // значение --mode
+};
+
+const std::vector<Mode> MODES = {
+    {"tsp", "2opt", "2opt"},
+    {"tsp", "2opt+3opt", "both"},  // весь конвейер: 3-opt после 2-opt, как в results_2opt_3opt.csv
+    {"ks",  "bnb",  "bnb"},
+    {"ks",  "ga",   "ga"},
+};
+
+const std::map<std::string, std::vector<std::string>> GENERATORS = {
+    {"tsp", {"uniform", "clustered"}},
+    {"ks",  {"uncorrelated", "strong", "subset"}},
+};
+
+const std::map<std::string, std::vector<long long>> SIZES = {
+    {"tsp", {100, 200, 500, 1000, 2000, 5000, 10000, 20000, 50000,
+             100000, 200000, 500000, 1000000}},
+    {"ks",  {100, 1000, 10000, 100000, 1000000}},
+};
+
+// Достаёт из вывода решателя время режима (мс) и значение целевой функции.
+// 2_opt_3opt печатает "name,dist_2opt,time_2opt,dist_3opt,time_3opt";
+// для 2opt+3opt время — сумма обеих фаз, длина — итоговая после 3-opt.
+// knapsack_solvers — строки "[BnB] Value=..., Weight=..., Time=... ms".
+bool parseOutput(const Mode &mode, const std::string &outFile, double &ms, double &objective) {
+    std::ifstream fin(outFile);
+    std::string line;
+    if (mode.problem == "tsp") {
+        if (!std::getline(fin, line))
+            return false;
+        std::vector<std::string> fields;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, ','))
+            fields.push_back(field);
+        if (fields.size() != 5)
+            return false;
+        if (mode.name == "2opt") {
+            objective = atof(fields[1].c_str());
+            ms = atof(fields[2].c_str());
+        } else {
+            objective = atof(fields[3].c_str());
+            ms = atof(fields[2].c_str()) + atof(fields[4].c_str());
+        }
+        return true;
+    }
+
+    std::string tag = (mode.name == "bnb") ? "[BnB]" : "[GenGA]";
+    while (std::getline(fin, line)) {
+        if (line.find(tag) == std::string::npos)
+            continue;
+        size_t v = line.find("Value=");
+        size_t t = line.find("Time=");
+        if (v == std::string::npos || t == std::string::npos)
+            return false;
+        objective = atof(line.c_str() + v + 6);
+        ms = atof(line.c_str() + t + 5);
+        return true;
+    }
+    return false;
+}
+
+// Процентиль методом ближайшего ранга (values не пуст)
+double percentile(std::vector<double> values, double p) {
+    std::sort(values.begin(), values.end());
+    size_t rank = (size_t)std::max(1.0, std::ceil(p * values.size()));
+    return values[rank - 1];
+}
+
+// --------------------------- Результаты --------------------------- //
+
+struct Row {
+    std::string problem, generator, mode;
+    long long n = 0;
+    int repeats = 0;
+    std::string status;     // ok, timeout, failed
+    double medianMs = 0, p95Ms = 0;
+    long peakRssKb = 0;
+    double medianObjective = 0;
+
+    std::string key() const {
+        return problem + "," + generator + "," + mode + "," + std::to_string(n);
+    }
+};
+
+const char *CSV_HEADER = "problem,generator,mode,n,repeats,status,median_ms,p95_ms,peak_rss_kb,median_objective";
+
+void writeRow(std::ostream &out, const Row &r) {
+    out << r.problem << "," << r.generator << "," << r.mode << "," << r.n << ","
+        << r.repeats << "," << r.status << ","
+        << std::fixed << std::setprecision(1) << r.medianMs << "," << r.p95Ms << ","
+        << r.peakRssKb << ","
+        << std::setprecision(6) << r.medianObjective << "\n";
+}
+
+std::vector<Row> readRows(const std::string &file) {
+    std::vector<Row> rows;
+    std::ifstream fin(file);
+    if (!fin.is_open()) {
+        std::cerr << "Не удалось открыть файл: " << file << std::endl;
+        return rows;
+    }
+    std::string line;
+    std::getline(fin, line); // заголовок
+    while (std::getline(fin, line)) {
+        std::vector<std::string> f;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, ','))
+            f.push_back(field);
+        if (f.size() != 10)
+            continue;
+        Row r;
+        r.problem = f[0];
+        r.generator = f[1];
+        r.mode = f[2];
+        r.n = atoll(f[3].c_str());
+        r.repeats = atoi(f[4].c_str());
+        r.status = f[5];
+        r.medianMs = atof(f[6].c_str());
+        r.p95Ms = atof(f[7].c_str());
+        r.peakRssKb = atol(f[8].c_str());
+        r.medianObjective = atof(f[9].c_str());
+        rows.push_back(r);
+    }
+    return rows;
+}
+
+// --------------------------- Прогон --------------------------- //
+
+// Путь к задаче; файл генерируется при первом обращении и дальше переиспользуется
+std::string ensureInstance(const Options &opt, const std::string &problem,
+                           const std::string &generator, long long n) {
+    fs::path dir = fs::path(opt.workDir) / "instances";
+    fs::create_directories(dir);
+    fs::path file = dir / (problem + "_" + generator + "_" + std::to_string(n) + "_s" + std::to_string(opt.seed));
+    if (fs::exists(file))
+        return file.string();
+
+    fs::path tmp = file.string() + ".tmp";
+    ProcResult gen = runProcess({(fs::path(opt.binDir) / "gen_instances").string(), problem, generator,
+                                 std::to_string(n), std::to_string(opt.seed)},
+                                opt.workDir, "", tmp.string(), 3600.0, 0);
+    if (!gen.ok) {
+        fs::remove(tmp);
+        return "";
+    }
+    fs::rename(tmp, file);
+    return file.string();
+}
+
+// Все повторы одного режима на одной задаче
+Row measure(const Options &opt, const Mode &mode, const std::string &generator,
+            long long n, const std::string &instance) {
+    Row row;
+    row.problem = mode.problem;
+    row.generator = generator;
+    row.mode = mode.name;
+    row.n = n;
+    row.status = "ok";
+
+    fs::path outFile = fs::path(opt.workDir) / "solver_stdout.txt";
+    std::vector<double> times, objectives;
+    for (int rep = 0; rep < opt.repeats; rep++) {
+        ProcResult pr;
+        if (mode.problem == "tsp") {
+            pr = runProcess({(fs::path(opt.binDir) / "2_opt_3opt").string(), "--mode", mode.solverMode,
+                             "bench", "bench_route.txt"},
+                            opt.workDir, instance, outFile.string(), opt.timeoutSec, opt.memLimitMb);
+        } else {
+            pr = runProcess({(fs::path(opt.binDir) / "knapsack_solvers").string(), "--mode", mode.solverMode,
+                             instance},
+                            opt.workDir, "", outFile.string(), opt.timeoutSec, opt.memLimitMb);
+        }
+        // Решатели дописывают результаты в каталог запуска — не даём им копиться
+        fs::remove_all(fs::path(opt.workDir) / "result_2opt_3opt");
+        fs::remove_all(fs::path(opt.workDir) / "result_BnB_GA");
+        fs::remove(fs::path(opt.workDir) / "results_BnB_GA.csv");
+
+        double ms = 0, objective = 0;
+        if (pr.timedOut) {
+            row.status = "timeout";
+        } else if (!pr.ok || !parseOutput(mode, outFile.string(), ms, objective)) {
+            row.status = "failed";
+        }
+        row.peakRssKb = std::max(row.peakRssKb, pr.peakRssKb);
+        if (row.status != "ok")
+            break;
+        times.push_back(ms);
+        objectives.push_back(objective);
+        row.repeats++;
+    }
+
+    if (!times.empty()) {
+        row.medianMs = percentile(times, 0.5);
+        row.p95Ms = percentile(times, 0.95);
+        row.medianObjective = percentile(objectives, 0.5);
+    }
+    return row;
+}
+
+// Кривые масштабирования: для каждого генератора и режима N растёт,
+// пока запуск укладывается в таймаут и лимит памяти
+int runSuite(const Options &opt) {
+    fs::create_directories(opt.workDir);
+    std::ofstream out(opt.out, std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Не удалось открыть файл: " << opt.out << std::endl;
+        return 1;
+    }
+    out << CSV_HEADER << "\n";
+
+    for (const auto &mode : MODES) {
+        if (!opt.only.empty() && opt.only != mode.problem)
+            continue;
+        for (const auto &generator : GENERATORS.at(mode.problem)) {
+            for (long long n : SIZES.at(mode.problem)) {
+                if (n > opt.maxN)
+                    break;
+                std::string instance = ensureInstance(opt, mode.problem, generator, n);
+                if (instance.empty()) {
+                    std::cerr << "Не удалось сгенерировать " << mode.problem << " " << generator
+                              << " N=" << n << std::endl;
+                    return 1;
+                }
+                Row row = measure(opt, mode, generator, n, instance);
+                writeRow(out, row);
+                out.flush();
+                std::cout << mode.problem << " " << std::left << std::setw(13) << generator
+                          << std::setw(10) << mode.name << " N=" << std::setw(8) << n << std::right
+                          << " " << row.status << "  median=" << std::fixed << std::setprecision(1)
+                          << row.medianMs << " ms  p95=" << row.p95Ms << " ms  rss="
+                          << row.peakRssKb << " KB" << std::endl;
+                if (row.status != "ok")
+                    break;
+            }
+        }
+    }
+    return 0;
+}
+
+// --------------------------- Сравнение --------------------------- //
+
+// Сравнивает прогоны по ключу (задача, генератор, режим, N).
+// Регрессия — режим перестал укладываться в лимиты, либо медиана времени
+// или пиковый RSS выросли больше чем на threshold. Возвращает 2 при регрессиях,
+// 1 — если файлы не прочитались или у них нет общих точек.
+int compareRuns(const std::string &baseFile, const std::string &newFile, const Options &opt) {
+    std::vector<Row> baseRows = readRows(baseFile);
+    std::vector<Row> newRows = readRows(newFile);
+    if (baseRows.empty() || newRows.empty())
+        return 1;
+
+    std::map<std::string, Row> base;
+    for (const auto &r : baseRows)
+        base[r.key()] = r;
+
+    int regressions = 0, improvements = 0, compared = 0;
+    std::cout << std::fixed << std::setprecision(1);
+    for (const auto &cur : newRows) {
+        auto it = base.find(cur.key());
+        if (it == base.end())
+            continue;
+        const Row &old = it->second;
+        compared++;
+
+        std::vector<std::string> issues;
+        if (old.status == "ok" && cur.status != "ok") {
+            issues.push_back("status " + old.status + " -> " + cur.status);
+        } else if (old.status == "ok" && cur.status == "ok") {
+            double delta = cur.medianMs - old.medianMs;
+            if (delta > opt.minDeltaMs && cur.medianMs > old.medianMs * (1.0 + opt.threshold)) {
+                std::ostringstream s;
+                s << std::fixed << std::setprecision(1) << "time " << old.medianMs << " -> " << cur.medianMs << " ms";
+                issues.push_back(s.str());
+            } else if (-delta > opt.minDeltaMs && cur.medianMs < old.medianMs * (1.0 - opt.threshold)) {
+                improvements++;
+            }
+            long rssDelta = cur.peakRssKb - old.peakRssKb;
+            if (rssDelta > 1024 && cur.peakRssKb > old.peakRssKb * (1.0 + opt.threshold)) {
+                issues.push_back("rss " + std::to_string(old.peakRssKb) + " -> "
+                                 + std::to_string(cur.peakRssKb) + " KB");
+            }
+        }
+
+        for (const auto &issue : issues) {
+            std::cout << "REGRESSION " << cur.problem << " " << cur.generator << " " << cur.mode
+                      << " N=" << cur.n << ": " << issue << "\n";
+            regressions++;
+        }
+    }
+
+    // Точки, которых не было в базе (кривая стала длиннее), тоже улучшения
+    for (const auto &cur : newRows) {
+        if (!base.count(cur.key()) && cur.status == "ok")
+            improvements++;
+    }
+
+    if (compared == 0) {
+        std::cerr << "Нет общих точек (задача, генератор, режим, N) в " << baseFile
+                  << " и " << newFile << std::endl;
+        return 1;
+    }
+
+    std::cout << "Compared " << compared << " points: " << regressions << " regression(s), "
+              << improvements << " improvement(s)" << std::endl;
+    return regressions == 0 ? 0 : 2;
+}
+
+// --------------------------- MAIN --------------------------- //
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    std::string compareBase, compareNew;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--compare" && i + 2 < argc) {
+            compareBase = argv[++i];
+            compareNew = argv[++i];
+        } else if (arg == "--bin-dir" && hasValue) {
+            opt.binDir = argv[++i];
+        } else if (arg == "--work-dir" && hasValue) {
+            opt.workDir = argv[++i];
+        } else if (arg == "--out" && hasValue) {
+            opt.out = argv[++i];
+        } else if (arg == "--baseline" && hasValue) {
+            opt.baseline = argv[++i];
+        } else if (arg == "--only" && hasValue) {
+            opt.only = argv[++i];
+        } else if (arg == "--repeats" && hasValue) {
+            opt.repeats = std::max(1, atoi(argv[++i]));
+        } else if (arg == "--timeout" && hasValue) {
+            opt.timeoutSec = atof(argv[++i]);
+        } else if (arg == "--mem-limit" && hasValue) {
+            opt.memLimitMb = atoll(argv[++i]);
+        } else if (arg == "--max-n" && hasValue) {
+            opt.maxN = atoll(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            opt.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--threshold" && hasValue) {
+            opt.threshold = atof(argv[++i]);
+        } else if (arg == "--min-delta-ms" && hasValue) {
+            opt.minDeltaMs = atof(argv[++i]);
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (!opt.only.empty() && !GENERATORS.count(opt.only)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    if (!compareBase.empty()) {
+        return compareRuns(compareBase, compareNew, opt);
+    }
+
+    // runSuite перезаписывает opt.out ещё до сравнения — базу нельзя писать поверх
+    if (!opt.baseline.empty()) {
+        std::error_code ec;
+        if (!fs::exists(opt.baseline)) {
+            std::cerr << "Базовый файл не найден: " << opt.baseline << std::endl;
+            return 1;
+        }
+        if (fs::equivalent(opt.baseline, opt.out, ec)) {
+            std::cerr << "--out совпадает с --baseline (" << opt.out
+                      << "), результаты затёрли бы базу; укажите другой --out" << std::endl;
+            return 1;
+        }
+    }
+
+    // Пути к бинарникам и задачам передаются процессам, работающим в workDir
+    opt.binDir = fs::absolute(opt.binDir).string();
+    opt.workDir = fs::absolute(opt.workDir).string();
+
+    // Иначе каждый запуск молча попал бы в CSV как failed
+    for (const char *bin : {"2_opt_3opt", "knapsack_solvers", "gen_instances"}) {
+        fs::path path = fs::path(opt.binDir) / bin;
+        if (access(path.c_str(), X_OK) != 0) {
+            std::cerr << "Нет исполняемого файла: " << path.string() << std::endl;
+            return 1;
+        }
+    }
+
+    int rc = runSuite(opt);
+    if (rc != 0 || opt.baseline.empty())
+        return rc;
+    return compareRuns(opt.baseline, opt.out, opt);
+}
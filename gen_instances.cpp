@@ -0,0 +1,113 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <algorithm>
+
+// Генератор тестовых задач в форматах data_2opt_3opt и data_BnB_GA.
+// Задача печатается в stdout; одинаковые параметры и seed дают одинаковый файл
+// (при одной и той же стандартной библиотеке C++).
+//
+//   gen_instances tsp uniform|clustered <N> [seed]
+//   gen_instances ks  uncorrelated|strong|subset <N> [seed]
+
+// --------------------------- TSP --------------------------- //
+
+const double TSP_SIDE = 1000000.0; // точки лежат в квадрате [0, TSP_SIDE]^2
+
+// Точки равномерно в квадрате
+void genTspUniform(int n, std::mt19937_64 &gen) {
+    std::uniform_real_distribution<double> coord(0.0, TSP_SIDE);
+    std::cout << n << "\n";
+    for (int i = 0; i < n; i++) {
+        double x = coord(gen);
+        double y = coord(gen);
+        std::cout << x << " " << y << "\n";
+    }
+}
+
+// Точки собраны в ~sqrt(N) нормально распределённых кластеров
+void genTspClustered(int n, std::mt19937_64 &gen) {
+    int k = std::max(1, (int)std::sqrt((double)n));
+    double sigma = TSP_SIDE / (4.0 * std::sqrt((double)k));
+
+    std::uniform_real_distribution<double> coord(0.0, TSP_SIDE);
+    std::vector<std::pair<double, double>> centers(k);
+    for (auto &c : centers) {
+        c.first = coord(gen);
+        c.second = coord(gen);
+    }
+
+    std::uniform_int_distribution<int> pick(0, k - 1);
+    std::normal_distribution<double> offset(0.0, sigma);
+    std::cout << n << "\n";
+    for (int i = 0; i < n; i++) {
+        const auto &c = centers[pick(gen)];
+        double x = std::min(TSP_SIDE, std::max(0.0, c.first + offset(gen)));
+        double y = std::min(TSP_SIDE, std::max(0.0, c.second + offset(gen)));
+        std::cout << x << " " << y << "\n";
+    }
+}
+
+// --------------------------- Рюкзак --------------------------- //
+
+const int KS_RANGE = 1000; // веса из [1, KS_RANGE]
+
+// Классические семейства (Pisinger): ценность не связана с весом,
+// ценность = вес + R/10, ценность = вес. Вместимость — половина суммарного веса.
+// Строки предметов — "вес ценность", как читает knapsack_solvers.
+void genKnapsack(const std::string &kind, int n, std::mt19937_64 &gen) {
+    std::uniform_int_distribution<int> dist(1, KS_RANGE);
+    std::vector<int> weight(n), value(n);
+    long long totalWeight = 0;
+    for (int i = 0; i < n; i++) {
+        weight[i] = dist(gen);
+        if (kind == "uncorrelated") {
+            value[i] = dist(gen);
+        } else if (kind == "strong") {
+            value[i] = weight[i] + KS_RANGE / 10;
+        } else {
+            value[i] = weight[i];
+        }
+        totalWeight += weight[i];
+    }
+
+    std::cout << n << " " << totalWeight / 2 << "\n";
+    for (int i = 0; i < n; i++) {
+        std::cout << weight[i] << " " << value[i] << "\n";
+    }
+}
+
+// --------------------------- MAIN --------------------------- //
+
+int main(int argc, char* argv[]) {
+    std::ios::sync_with_stdio(false);
+
+    std::string problem = (argc > 1) ? argv[1] : "";
+    std::string kind = (argc > 2) ? argv[2] : "";
+    bool known = (problem == "tsp" && (kind == "uniform" || kind == "clustered"))
+              || (problem == "ks" && (kind == "uncorrelated" || kind == "strong" || kind == "subset"));
+    int n = (argc > 3) ? atoi(argv[3]) : 0;
+    if (!known || n <= 0) {
+        std::cerr << "Usage: " << argv[0] << " tsp uniform|clustered <N> [seed]\n"
+                  << "       " << argv[0] << " ks uncorrelated|strong|subset <N> [seed]\n";
+        return 1;
+    }
+    unsigned long long seed = (argc > 4) ? std::strtoull(argv[4], nullptr, 10) : 1;
+    std::mt19937_64 gen(seed);
+
+    if (problem == "tsp") {
+        std::cout << std::fixed << std::setprecision(3);
+        if (kind == "uniform") {
+            genTspUniform(n, gen);
+        } else {
+            genTspClustered(n, gen);
+        }
+    } else {
+        genKnapsack(kind, n, gen);
+    }
+    return 0;
+}
@@ -8,6 +8,12 @@
 #include <chrono>
 #include <queue>
 #include <filesystem>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <numeric>
+#include <map>
 
 
 namespace fs = std::filesystem;
@@ -50,6 +56,24 @@ long long currentTimeMillis() {
     return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
 }
 
+// --------------------------- Случайные числа --------------------------- //
+// rand() не потокобезопасен, поэтому у каждого потока свой генератор
+std::mt19937 &rng() {
+    thread_local std::mt19937 gen((unsigned)time(nullptr)
+                                  ^ (unsigned)std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    return gen;
+}
+
+// Случайное целое из [0, n)
+int randInt(int n) {
+    return std::uniform_int_distribution<int>(0, n - 1)(rng());
+}
+
+// Случайное вещественное из [0, 1)
+double randUnit() {
+    return std::uniform_real_distribution<double>(0.0, 1.0)(rng());
+}
+
 // --------------------------- Функция ремонта для GA --------------------------- //
 // Если особь перегружена, удаляем предметы с наименьшим соотношением value/weight
 void repairIndividual(Individual &ind, const std::vector<Item> &items, int capacity) {
@@ -102,7 +126,7 @@ Individual makeIndividual(int n) {
     Individual ind;
     ind.chromosome.resize(n);
     for (int i = 0; i < n; i++) {
-        ind.chromosome[i] = rand() % 2; 
+        ind.chromosome[i] = randInt(2);
     }
     ind.fitness = 0;
     return ind;
@@ -110,7 +134,7 @@ Individual makeIndividual(int n) {
 
 void crossover(Individual &parent1, Individual &parent2) {
     int size = (int)parent1.chromosome.size();
-    int point = rand() % size;
+    int point = randInt(size);
     for (int i = point; i < size; i++) {
         std::swap(parent1.chromosome[i], parent2.chromosome[i]);
     }
@@ -118,7 +142,7 @@ void crossover(Individual &parent1, Individual &parent2) {
 
 void mutate(Individual &ind, double mutationRate) {
     for (size_t i = 0; i < ind.chromosome.size(); i++) {
-        double r = (double)rand() / RAND_MAX;
+        double r = randUnit();
         if (r < mutationRate) {
             ind.chromosome[i] = 1 - ind.chromosome[i];
         }
@@ -128,8 +152,8 @@ void mutate(Individual &ind, double mutationRate) {
 // простая турнирная селекция
 Individual tournamentSelection(const std::vector<Individual> &population) {
     int size = (int)population.size();
-    int i1 = rand() % size;
-    int i2 = rand() % size;
+    int i1 = randInt(size);
+    int i2 = randInt(size);
     return (population[i1].fitness > population[i2].fitness) ? population[i1] : population[i2];
 }
 
@@ -317,118 +341,106 @@ BBResult branchAndBoundKnapsack(const std::vector<Item> &origItems, int capacity
     return res;
 }
 
-// --------------------------- MAIN --------------------------- //
-
-int main(int argc, char* argv[]) {
-    if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <input_file>\n";
-        return 1;
-    }
+// --------------------------- Решение одного файла --------------------------- //
+
+// Итог по одному входному файлу — одна строка results_BnB_GA.csv
+struct RunResult {
+    std::string inputFile;
+    int valueBB = 0;
+    int weightBB = 0;
+    long long timeBB = 0;
+    int valueGA = 0;
+    int weightGA = 0;
+    long long timeGA = 0;
+};
 
-    // Инициализируем генератор случайных чисел один раз
-    srand((unsigned)time(nullptr));
+// Какие методы запускать: "both", "bnb" или "ga"
+bool runsBB(const std::string &mode) { return mode == "both" || mode == "bnb"; }
+bool runsGA(const std::string &mode) { return mode == "both" || mode == "ga"; }
 
-    std::string inputFile = argv[1];
+// Имя файла результатов в result_BnB_GA: имя входного файла без пути и расширения
+std::string resultName(const std::string &inputFile) {
+    return fs::path(inputFile).stem().string();  // например, "ks_100_1" для "data/ks_100_1.txt"
+}
 
+// Решает задачу из inputFile методами из mode, пишет result_BnB_GA/<имя>.csv
+// и заполняет out. Возвращает false, если файл не удалось прочитать.
+bool solveFile(const std::string &inputFile, const std::string &mode, RunResult &out) {
     // Считывание данных из файла
     std::ifstream fin(inputFile);
     if (!fin.is_open()) {
         std::cerr << "Не удалось открыть файл: " << inputFile << std::endl;
-        return 1;
+        return false;
     }
 
-    int N, CAP;
+    int N = 0, CAP = 0;
     fin >> N >> CAP;
+    if (!fin || N <= 0) {
+        std::cerr << "Некорректный входной файл: " << inputFile << std::endl;
+        return false;
+    }
     std::vector<Item> items(N);
     for (int i = 0; i < N; i++) {
         fin >> items[i].weight >> items[i].value;
     }
+    if (!fin) {
+        std::cerr << "Некорректный входной файл: " << inputFile << std::endl;
+        return false;
+    }
     fin.close();
 
     // =============== 1) Метод ветвей и границ ===============
-    long long startBB = currentTimeMillis();
-    BBResult bbRes = branchAndBoundKnapsack(items, CAP);
-    long long endBB = currentTimeMillis();
-    long long timeBB = endBB - startBB; // миллисекунды
-    int bestValBB = bbRes.bestValue;
+    BBResult bbRes{0, {}};
+    long long timeBB = 0;
+    if (runsBB(mode)) {
+        long long startBB = currentTimeMillis();
+        bbRes = branchAndBoundKnapsack(items, CAP);
+        long long endBB = currentTimeMillis();
+        timeBB = endBB - startBB; // миллисекунды
+    }
+
+    // BnB возвращает выбор в отсортированном по удельной ценности порядке
+    std::vector<Item> sortedItems = items;
+    std::sort(sortedItems.begin(), sortedItems.end(), [](const Item &a, const Item &b){
+        return (double)a.value/a.weight > (double)b.value/b.weight;
+    });
 
     // Вычисляем суммарный вес для решения BnB
     int totalWBB = 0;
-    {
-        std::vector<Item> sortedItems = items;
-        std::sort(sortedItems.begin(), sortedItems.end(), [](const Item &a, const Item &b){
-            return (double)a.value/a.weight > (double)b.value/b.weight;
-        });
-        for (size_t i = 0; i < bbRes.bestSelection.size(); i++) {
-            if (bbRes.bestSelection[i] == 1) {
-                totalWBB += sortedItems[i].weight;
-            }
+    for (size_t i = 0; i < bbRes.bestSelection.size(); i++) {
+        if (bbRes.bestSelection[i] == 1) {
+            totalWBB += sortedItems[i].weight;
         }
     }
 
     // =============== 2) Генетический алгоритм ===============
-    long long startGA = currentTimeMillis();
-    GAResult gaRes = geneticKnapsack(items, CAP);
-    long long endGA = currentTimeMillis();
-    long long timeGA = endGA - startGA; // миллисекунды
-    int bestValGA = gaRes.bestValue;
+    GAResult gaRes{0, {}};
+    long long timeGA = 0;
+    if (runsGA(mode)) {
+        long long startGA = currentTimeMillis();
+        gaRes = geneticKnapsack(items, CAP);
+        long long endGA = currentTimeMillis();
+        timeGA = endGA - startGA; // миллисекунды
+    }
 
     // Вычисляем суммарный вес для решения GA
     int totalWGA = 0;
-    for (int i = 0; i < N; i++) {
+    for (int i = 0; i < (int)gaRes.bestChromosome.size(); i++) {
         if (gaRes.bestChromosome[i] == 1) {
             totalWGA += items[i].weight;
         }
     }
 
-    // Вывод результатов в консоль
-    std::cout << "File: " << inputFile << "\n";
-    std::cout << "  [BnB]   Value=" << bestValBB << ", Weight=" << totalWBB 
-              << ", Time=" << timeBB << " ms\n";
-    std::cout << "  [GenGA] Value=" << bestValGA << ", Weight=" << totalWGA
-              << ", Time=" << timeGA << " ms\n";
-
-    // Запись в общий CSV-файл results.csv (добавляем строку)
-    {
-        std::ofstream fout("results_BnB_GA.csv", std::ios::app);
-        if (fout.tellp() == 0) {
-            fout << "File,weight_BnB,time_BnB_ms,weight_GA,time_GA_ms\n";
-        }
-        fout << inputFile << ","
-             << totalWBB << ","
-             << timeBB << ","
-             << totalWGA << ","
-             << timeGA << "\n";
-    }
-
     // Вывод результатов каждого метода в отдельный CSV-файл (имя файла основано на inputFile)
     {
-        if (!fs::exists("result_BnB_GA")) {
-            if (!fs::create_directory("result_BnB_GA")) {
-                std::cerr << "Не удалось создать директорию 'result'" << std::endl;
-                return 1;
-            }
-        }
-    
-        // Извлекаем только имя файла из пути inputFile
-        fs::path p(inputFile);
-        std::string filename = p.filename().string();  // например, "ks_100_1" или "ks_100_1.txt"
-        // Удаляем расширение, если оно есть:
-        filename = fs::path(filename).stem().string();
-    
         // Формируем путь для сохранения результатов
-        std::string outName = "result_BnB_GA/" + filename + ".csv";
+        std::string outName = "result_BnB_GA/" + resultName(inputFile) + ".csv";
 
         std::ofstream fout(outName, std::ios::app);
 
         // 1) Branch & Bound: вывод весов выбранных предметов
-        fout << "BnB,";
-        {
-            std::vector<Item> sortedItems = items;
-            std::sort(sortedItems.begin(), sortedItems.end(), [](const Item &a, const Item &b){
-                return (double)a.value/a.weight > (double)b.value/b.weight;
-            });
-
+        if (runsBB(mode)) {
+            fout << "BnB,";
             for (size_t i = 0; i < bbRes.bestSelection.size(); i++) {
                 if (bbRes.bestSelection[i] == 1) {
                     fout << sortedItems[i].weight;
@@ -439,22 +451,220 @@ int main(int argc, char* argv[]) {
                     fout << ",";
                 }
             }
+            fout << "\n";
         }
-        fout << "\n";
 
         // 2) Genetic Algorithm: вывод весов выбранных предметов
-        fout << "GA,";
-        for (int i = 0; i < N; i++) {
-            if (gaRes.bestChromosome[i] == 1) {
-                fout << items[i].weight;
-            } else {
-                fout << 0;
+        if (runsGA(mode)) {
+            fout << "GA,";
+            for (int i = 0; i < N; i++) {
+                if (gaRes.bestChromosome[i] == 1) {
+                    fout << items[i].weight;
+                } else {
+                    fout << 0;
+                }
+                if (i < N - 1) {
+                    fout << ",";
+                }
+            }
+            fout << "\n";
+        }
+    }
+
+    out.inputFile = inputFile;
+    out.valueBB = bbRes.bestValue;
+    out.weightBB = totalWBB;
+    out.timeBB = timeBB;
+    out.valueGA = gaRes.bestValue;
+    out.weightGA = totalWGA;
+    out.timeGA = timeGA;
+    return true;
+}
+
+// Вывод результатов в консоль
+void printResult(const RunResult &r, const std::string &mode) {
+    std::cout << "File: " << r.inputFile << "\n";
+    if (runsBB(mode)) {
+        std::cout << "  [BnB]   Value=" << r.valueBB << ", Weight=" << r.weightBB
+                  << ", Time=" << r.timeBB << " ms\n";
+    }
+    if (runsGA(mode)) {
+        std::cout << "  [GenGA] Value=" << r.valueGA << ", Weight=" << r.weightGA
+                  << ", Time=" << r.timeGA << " ms\n";
+    }
+}
+
+void writeCsvHeader(std::ostream &fout) {
+    fout << "File,weight_BnB,time_BnB_ms,weight_GA,time_GA_ms\n";
+}
+
+void writeCsvRow(std::ostream &fout, const RunResult &r) {
+    fout << r.inputFile << ","
+         << r.weightBB << ","
+         << r.timeBB << ","
+         << r.weightGA << ","
+         << r.timeGA << "\n";
+}
+
+// --------------------------- Пакетный режим --------------------------- //
+
+// Список входных файлов: все файлы каталога (по имени) либо строки манифеста.
+// В манифесте пустые строки и строки с '#' пропускаются, относительные пути
+// считаются от каталога манифеста.
+std::vector<std::string> listInputs(const std::string &source) {
+    std::vector<std::string> files;
+    if (fs::is_directory(source)) {
+        for (const auto &entry : fs::directory_iterator(source)) {
+            if (entry.is_regular_file()) {
+                files.push_back(entry.path().string());
             }
-            if (i < N - 1) {
-                fout << ",";
+        }
+        std::sort(files.begin(), files.end());
+        return files;
+    }
+
+    std::ifstream manifest(source);
+    if (!manifest.is_open()) {
+        std::cerr << "Не удалось открыть манифест: " << source << std::endl;
+        return files;
+    }
+    fs::path base = fs::path(source).parent_path();
+    std::string line;
+    while (std::getline(manifest, line)) {
+        line.erase(0, line.find_first_not_of(" \t\r"));
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if (line.empty() || line[0] == '#')
+            continue;
+        fs::path p(line);
+        files.push_back(p.is_relative() ? (base / p).string() : p.string());
+    }
+    return files;
+}
+
+// Размер задачи — число предметов N из первой строки файла
+long long instanceSize(const std::string &file) {
+    std::ifstream fin(file);
+    long long n = 0;
+    fin >> n;
+    return n;
+}
+
+// Решает все файлы на пуле из threadCount потоков, начиная с самых больших,
+// и пишет results_BnB_GA.csv заново — строки в порядке inputs.
+// Время каждого метода меряется под нагрузкой от соседних потоков, а BnB
+// обрывается по TIME_LIMIT_MS, поэтому для замеров нужен threadCount = 1.
+int runBatch(const std::vector<std::string> &inputs, const std::string &mode, unsigned threadCount) {
+    const size_t count = inputs.size();
+
+    // Два входа с одинаковым именем результата писали бы в один файл одновременно
+    std::map<std::string, size_t> owners;
+    for (size_t i = 0; i < count; i++) {
+        auto [it, inserted] = owners.emplace(resultName(inputs[i]), i);
+        if (!inserted) {
+            std::cerr << "Файлы " << inputs[it->second] << " и " << inputs[i]
+                      << " пишут в один result_BnB_GA/" << it->first << ".csv" << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<long long> sizes(count);
+    for (size_t i = 0; i < count; i++) {
+        sizes[i] = instanceSize(inputs[i]);
+    }
+    std::vector<size_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b){
+        return sizes[a] > sizes[b];
+    });
+
+    std::vector<RunResult> results(count);
+    std::vector<char> solved(count, 0);
+    std::atomic<size_t> next{0};
+    std::mutex consoleMutex;
+
+    auto worker = [&]() {
+        for (size_t k = next++; k < count; k = next++) {
+            size_t idx = order[k];
+            solved[idx] = solveFile(inputs[idx], mode, results[idx]);
+            if (solved[idx]) {
+                std::lock_guard<std::mutex> lock(consoleMutex);
+                printResult(results[idx], mode);
             }
         }
-        fout << "\n";
+    };
+
+    threadCount = std::max(1u, std::min<unsigned>(threadCount, (unsigned)std::max<size_t>(count, 1)));
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threadCount; t++) {
+        pool.emplace_back(worker);
+    }
+    for (auto &th : pool) {
+        th.join();
+    }
+
+    std::ofstream fout("results_BnB_GA.csv", std::ios::trunc);
+    writeCsvHeader(fout);
+    int failed = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (solved[i]) {
+            writeCsvRow(fout, results[i]);
+        } else {
+            failed++;
+        }
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+// --------------------------- MAIN --------------------------- //
+
+int main(int argc, char* argv[]) {
+    // Необязательный первый параметр: --mode both|bnb|ga (по умолчанию both)
+    std::string prog = argv[0];
+    std::string mode = "both";
+    if (argc > 2 && std::string(argv[1]) == "--mode") {
+        mode = argv[2];
+        argv += 2;
+        argc -= 2;
+    }
+
+    bool batch = argc >= 3 && std::string(argv[1]) == "--batch";
+    if (argc < 2 || (!batch && std::string(argv[1]) == "--batch") || (!runsBB(mode) && !runsGA(mode))) {
+        std::cerr << "Usage: " << prog << " [--mode both|bnb|ga] <input_file>\n"
+                  << "       " << prog << " [--mode both|bnb|ga] --batch <dir|manifest> [threads]\n";
+        return 1;
+    }
+
+    if (!fs::exists("result_BnB_GA")) {
+        if (!fs::create_directory("result_BnB_GA")) {
+            std::cerr << "Не удалось создать директорию 'result_BnB_GA'" << std::endl;
+            return 1;
+        }
+    }
+
+    if (batch) {
+        std::vector<std::string> inputs = listInputs(argv[2]);
+        if (inputs.empty()) {
+            std::cerr << "Нет входных файлов: " << argv[2] << std::endl;
+            return 1;
+        }
+        unsigned threads = (argc > 3) ? (unsigned)std::max(1, atoi(argv[3]))
+                                      : std::max(1u, std::thread::hardware_concurrency());
+        return runBatch(inputs, mode, threads);
+    }
+
+    RunResult res;
+    if (!solveFile(argv[1], mode, res)) {
+        return 1;
+    }
+    printResult(res, mode);
+
+    // Запись в общий CSV-файл results_BnB_GA.csv (добавляем строку)
+    {
+        std::ofstream fout("results_BnB_GA.csv", std::ios::app);
+        if (fout.tellp() == 0) {
+            writeCsvHeader(fout);
+        }
+        writeCsvRow(fout, res);
     }
 
     return 0;
@@ -0,0 +1,17 @@
+#!/bin/sh
+# Бенчмарк решателей под Linux: собирает 2_opt_3opt, knapsack_solvers, gen_instances
+# и benchmark (без -static, с -O2) и запускает benchmark с переданными параметрами.
+# Примеры:
+#   ./run_benchmark.sh                                    # полный прогон -> bench_results.csv
+#   ./run_benchmark.sh --only tsp --repeats 3 --timeout 20
+#   ./run_benchmark.sh --out new.csv --baseline bench_results.csv   # код 2 при регрессиях
+#   (--out должен отличаться от --baseline, иначе прогон не начнётся)
+set -e
+cd "$(dirname "$0")"
+
+g++ 2opt_3opt.cpp -O2 -std=c++17 -pthread -o 2_opt_3opt
+g++ knapsack_solvers.cpp -O2 -std=c++17 -pthread -o knapsack_solvers
+g++ gen_instances.cpp -O2 -std=c++17 -o gen_instances
+g++ benchmark.cpp -O2 -std=c++17 -o benchmark
+
+./benchmark "$@"
@@ -0,0 +1,15 @@
+#!/bin/sh
+# Linux-аналог run_tests_2opt_3opt.bat: все файлы data_2opt_3opt решаются одним
+# процессом на пуле потоков, итог — results_2opt_3opt.csv, маршруты — result_2opt_3opt/.
+# Использование: ./run_tests_2opt_3opt.sh [каталог|манифест] [число потоков]
+# По умолчанию потоков столько, сколько ядер. Тогда time_*_ms меряются, пока
+# соседние задачи делят ядра и память. Для воспроизводимых замеров передавайте 1:
+#   ./run_tests_2opt_3opt.sh data_2opt_3opt 1
+set -e
+cd "$(dirname "$0")"
+
+g++ 2opt_3opt.cpp -O2 -std=c++17 -pthread -o 2_opt_3opt
+
+./2_opt_3opt --batch "${1:-data_2opt_3opt}" ${2:+"$2"}
+
+echo "Done!"
@@ -2,11 +2,13 @@
 
 chcp 65001 && g++ knapsack_solvers.cpp -static -static-libgcc -static-libstdc++ -std=c++17 -o knapsack_solvers.exe
 
-for %%F in (data_BnB_GA\*) do (
-    echo Запуск для файла %%F
-    knapsack_solvers.exe %%F
-    echo.
-)
+rem Все файлы решаются одним процессом, results_BnB_GA.csv перезаписывается целиком
+rem Использование: run_tests_BnB_GA.bat [каталог^|манифест] [число потоков]
+rem По умолчанию потоков столько, сколько ядер: time_*_ms меряются при параллельной
+rem нагрузке, а BnB с лимитом по времени может дать другой ответ. Для замеров времени передавайте 1.
+set INPUT=%~1
+if "%INPUT%"=="" set INPUT=data_BnB_GA
+knapsack_solvers.exe --batch %INPUT% %2
 
 
 pause
@@ -0,0 +1,16 @@
+#!/bin/sh
+# Linux-аналог run_tests_BnB_GA.bat: все файлы data_BnB_GA решаются одним
+# процессом на пуле потоков, итог — results_BnB_GA.csv.
+# Использование: ./run_tests_BnB_GA.sh [каталог|манифест] [число потоков]
+# По умолчанию потоков столько, сколько ядер. Тогда time_*_ms меряются, пока
+# соседние задачи делят ядра и память, а BnB с лимитом по времени может дать
+# другой ответ. Для воспроизводимых замеров передавайте 1 потоком:
+#   ./run_tests_BnB_GA.sh data_BnB_GA 1
+set -e
+cd "$(dirname "$0")"
+
+g++ knapsack_solvers.cpp -O2 -std=c++17 -pthread -o knapsack_solvers
+
+./knapsack_solvers --batch "${1:-data_BnB_GA}" ${2:+"$2"}
+
+echo "Done!"